@@ -3,15 +3,373 @@
 #include <string>
 #include <sstream>
 #include <cctype>
+#include <cstdlib>
+#include <fstream>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+#include <cstddef>
+#include <cstring>
+#include <vector>
+#include <thread>
+#include <algorithm>
+#include <climits>
+#include <cerrno>
+#include <cmath>
 
 using namespace std;
 
+// Set to 0 at compile time (-DNTSHOP_METRICS=0) to compile all timers out.
+#ifndef NTSHOP_METRICS
+#define NTSHOP_METRICS 1
+#endif
+
 const int MAX_PRODUCTS = 50;
 const int MAX_USERS = 50;
 const int MAX_ORDERS = 200;
 const int MAX_CART_ITEMS = 20;
 const int MAX_ORDER_ITEMS = 20;
 
+enum MetricOp { OP_CHECKOUT, OP_ADD_ORDER, OP_GET_PRODUCT, OP_FIND_USER, OP_COUNT };
+const char* const METRIC_OP_NAMES[OP_COUNT] = { "checkout", "addOrder", "getProductById", "findUser" };
+
+// Timers count in raw ticks and are converted to ns only when a report is
+// read: the TSC costs a few ns to read, steady_clock ~30 ns on common VMs.
+inline uint64_t metricTicks() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return (uint64_t)chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+// HDR-style buckets: exact below 2*HIST_SUB_COUNT ticks, then HIST_SUB_COUNT
+// linear sub-buckets per power of two (about 6% relative error).
+const int HIST_SUB_BITS = 4;
+const int HIST_SUB_COUNT = 1 << HIST_SUB_BITS;
+const int HIST_BUCKETS = (64 - HIST_SUB_BITS + 1) * HIST_SUB_COUNT;
+
+// Every call is counted, but after METRIC_FULL_CALLS calls of one operation
+// on a thread only one in METRIC_SAMPLE_EVERY is timed. Reading the clock
+// costs more than a product or user lookup does.
+const uint64_t METRIC_FULL_CALLS = 1024;
+const uint64_t METRIC_SAMPLE_EVERY = 32;   // must be a power of two
+
+int histogramBucket(uint64_t ticks) {
+    if (ticks < (uint64_t)(2 * HIST_SUB_COUNT)) return (int)ticks;
+#if defined(__GNUC__)
+    int msb = 63 - __builtin_clzll(ticks);
+#else
+    int msb = 0;
+    for (uint64_t v = ticks; v > 1; v >>= 1) msb++;
+#endif
+    int shift = msb - HIST_SUB_BITS;
+    return (shift + 1) * HIST_SUB_COUNT + (int)((ticks >> shift) - HIST_SUB_COUNT);
+}
+
+uint64_t histogramBucketLow(int idx) {
+    if (idx < 2 * HIST_SUB_COUNT) return (uint64_t)idx;
+    int shift = idx / HIST_SUB_COUNT - 1;
+    return (uint64_t)(HIST_SUB_COUNT + idx % HIST_SUB_COUNT) << shift;
+}
+
+uint64_t histogramBucketWidth(int idx) {
+    if (idx < 2 * HIST_SUB_COUNT) return 1;
+    return (uint64_t)1 << (idx / HIST_SUB_COUNT - 1);
+}
+
+// Merged, read-side copy of one operation's histogram across all threads.
+class HistogramSnapshot {
+    uint64_t counts[HIST_BUCKETS];
+    uint64_t total;
+    uint64_t timed;
+    uint64_t sumTicks;
+    uint64_t maxTicks;
+public:
+    HistogramSnapshot() : total(0), timed(0), sumTicks(0), maxTicks(0) {
+        for (int i = 0; i < HIST_BUCKETS; ++i) counts[i] = 0;
+    }
+
+    void add(int bucket, uint64_t n) { counts[bucket] += n; timed += n; }
+    void addTotals(uint64_t calls, uint64_t t, uint64_t mx) {
+        total += calls;
+        sumTicks += t;
+        if (mx > maxTicks) maxTicks = mx;
+    }
+
+    uint64_t getCount() const { return total; }
+    uint64_t getMaxTicks() const { return maxTicks; }
+    double getMeanTicks() const { return timed ? (double)sumTicks / timed : 0.0; }
+
+    uint64_t percentileTicks(double q) const {
+        uint64_t seen = 0;
+        for (int i = 0; i < HIST_BUCKETS; ++i) seen += counts[i];
+        if (seen == 0) return 0;
+        uint64_t rank = (uint64_t)(q * seen);
+        if (rank >= seen) rank = seen - 1;
+        uint64_t cumulative = 0;
+        for (int i = 0; i < HIST_BUCKETS; ++i) {
+            cumulative += counts[i];
+            if (cumulative > rank) {
+                uint64_t mid = histogramBucketLow(i) + histogramBucketWidth(i) / 2;
+                return mid < maxTicks ? mid : maxTicks;
+            }
+        }
+        return maxTicks;
+    }
+};
+
+// Per-thread recording slot. Only the owning thread writes, so updates are
+// plain relaxed load/store pairs; readers merge all slots on demand.
+class ThreadMetrics {
+    atomic<uint64_t> buckets[OP_COUNT][HIST_BUCKETS];
+    atomic<uint64_t> calls[OP_COUNT];
+    atomic<uint64_t> sumTicks[OP_COUNT];
+    atomic<uint64_t> maxTicks[OP_COUNT];
+public:
+    ThreadMetrics* next;
+
+    ThreadMetrics() : next(NULL) {
+        for (int op = 0; op < OP_COUNT; ++op) {
+            for (int i = 0; i < HIST_BUCKETS; ++i) buckets[op][i].store(0, memory_order_relaxed);
+            calls[op].store(0, memory_order_relaxed);
+            sumTicks[op].store(0, memory_order_relaxed);
+            maxTicks[op].store(0, memory_order_relaxed);
+        }
+    }
+
+    // Counts a call and says whether it should be timed.
+    bool countCall(MetricOp op) {
+        uint64_t n = calls[op].load(memory_order_relaxed);
+        calls[op].store(n + 1, memory_order_relaxed);
+        return n < METRIC_FULL_CALLS || (n & (METRIC_SAMPLE_EVERY - 1)) == 0;
+    }
+
+    void record(MetricOp op, uint64_t ticks) {
+        atomic<uint64_t>& b = buckets[op][histogramBucket(ticks)];
+        b.store(b.load(memory_order_relaxed) + 1, memory_order_relaxed);
+        sumTicks[op].store(sumTicks[op].load(memory_order_relaxed) + ticks, memory_order_relaxed);
+        if (ticks > maxTicks[op].load(memory_order_relaxed)) maxTicks[op].store(ticks, memory_order_relaxed);
+    }
+
+    void mergeInto(MetricOp op, HistogramSnapshot& snap) const {
+        for (int i = 0; i < HIST_BUCKETS; ++i) {
+            uint64_t n = buckets[op][i].load(memory_order_relaxed);
+            if (n) snap.add(i, n);
+        }
+        snap.addTotals(calls[op].load(memory_order_relaxed),
+                       sumTicks[op].load(memory_order_relaxed),
+                       maxTicks[op].load(memory_order_relaxed));
+    }
+};
+
+class Metrics {
+    static atomic<ThreadMetrics*> head;
+    static chrono::steady_clock::time_point startTime;
+    static uint64_t startTicks;
+    static chrono::steady_clock::time_point lastReportTime;
+    static uint64_t lastReportCalls[OP_COUNT];
+
+    static ThreadMetrics* registerThread() {
+        ThreadMetrics* slot = new ThreadMetrics();
+        ThreadMetrics* old = head.load(memory_order_relaxed);
+        do { slot->next = old; } while (!head.compare_exchange_weak(old, slot, memory_order_release, memory_order_relaxed));
+        return slot;
+    }
+
+public:
+    static ThreadMetrics& local() {
+        // Constant-initialised, so access needs no TLS init guard call.
+        static thread_local ThreadMetrics* slot = NULL;
+        if (!slot) slot = registerThread();
+        return *slot;
+    }
+
+    static HistogramSnapshot snapshot(MetricOp op) {
+        HistogramSnapshot snap;
+        for (ThreadMetrics* t = head.load(memory_order_acquire); t; t = t->next)
+            t->mergeInto(op, snap);
+        return snap;
+    }
+
+    static double uptimeSeconds() {
+        return chrono::duration<double>(chrono::steady_clock::now() - startTime).count();
+    }
+
+    // Tick rate measured over the whole uptime, so no calibration pause is needed.
+    static double nsPerTick() {
+        uint64_t ticks = metricTicks() - startTicks;
+        double ns = chrono::duration<double, nano>(chrono::steady_clock::now() - startTime).count();
+        return ticks > 0 ? ns / ticks : 1.0;
+    }
+
+    // Rate/s covers the interval since the previous report (or since start);
+    // the other columns are lifetime figures. Called from the admin menu only.
+    static void report(ostream& out) {
+        chrono::steady_clock::time_point now = chrono::steady_clock::now();
+        double uptime = chrono::duration<double>(now - startTime).count();
+        double interval = chrono::duration<double>(now - lastReportTime).count();
+        double usPerTick = nsPerTick() / 1000.0;
+        lastReportTime = now;
+        out << "\n--- Performance Metrics (uptime " << fixed << setprecision(2) << uptime
+            << " s, rates over last " << interval << " s) ---" << endl;
+        if (!NTSHOP_METRICS) out << "(metrics compiled out: rebuild with NTSHOP_METRICS=1)" << endl;
+        out << left << setw(16) << "Operation" << right
+            << setw(10) << "Calls" << setw(12) << "Rate/s"
+            << setw(12) << "Mean(us)" << setw(12) << "p50(us)" << setw(12) << "p99(us)"
+            << setw(12) << "p999(us)" << setw(12) << "Max(us)" << endl;
+        for (int op = 0; op < OP_COUNT; ++op) {
+            HistogramSnapshot snap = snapshot((MetricOp)op);
+            uint64_t recent = snap.getCount() - lastReportCalls[op];
+            lastReportCalls[op] = snap.getCount();
+            out << left << setw(16) << METRIC_OP_NAMES[op] << right
+                << setw(10) << snap.getCount()
+                << setw(12) << (interval > 0 ? recent / interval : 0.0)
+                << setw(12) << snap.getMeanTicks() * usPerTick
+                << setw(12) << snap.percentileTicks(0.50) * usPerTick
+                << setw(12) << snap.percentileTicks(0.99) * usPerTick
+                << setw(12) << snap.percentileTicks(0.999) * usPerTick
+                << setw(12) << snap.getMaxTicks() * usPerTick << endl;
+        }
+        out << "--------------------------------" << endl;
+    }
+};
+
+atomic<ThreadMetrics*> Metrics::head(NULL);
+chrono::steady_clock::time_point Metrics::startTime = chrono::steady_clock::now();
+uint64_t Metrics::startTicks = metricTicks();
+chrono::steady_clock::time_point Metrics::lastReportTime = Metrics::startTime;
+uint64_t Metrics::lastReportCalls[OP_COUNT] = { 0 };
+
+class ScopedTimer {
+    MetricOp op;
+    ThreadMetrics& slot;
+    bool timed;
+    uint64_t start;
+public:
+    explicit ScopedTimer(MetricOp o)
+        : op(o), slot(Metrics::local()), timed(slot.countCall(o)), start(timed ? metricTicks() : 0) {}
+    ~ScopedTimer() {
+        if (timed) slot.record(op, metricTicks() - start);
+    }
+};
+
+#if NTSHOP_METRICS
+#define SHOP_METRIC_SCOPE(op) ScopedTimer shopMetricTimer_(op)
+#else
+#define SHOP_METRIC_SCOPE(op) ((void)0)
+#endif
+
+enum OrderStatus { STATUS_PLACED, STATUS_PAID, STATUS_SHIPPED, STATUS_DELIVERED,
+                   STATUS_CANCELLED, STATUS_RETURNED, STATUS_COUNT };
+const char* const ORDER_STATUS_NAMES[STATUS_COUNT] = { "Placed", "Paid", "Shipped", "Delivered", "Cancelled", "Returned" };
+
+// ORDER_TRANSITIONS[from][to]: COD orders may ship while still unpaid, and a
+// shipment refused at the door goes straight to Returned.
+const bool ORDER_TRANSITIONS[STATUS_COUNT][STATUS_COUNT] = {
+    /* Placed    */ { false, true,  true,  false, true,  false },
+    /* Paid      */ { false, false, true,  false, true,  false },
+    /* Shipped   */ { false, false, false, true,  false, true  },
+    /* Delivered */ { false, false, false, false, false, true  },
+    /* Cancelled */ { false, false, false, false, false, false },
+    /* Returned  */ { false, false, false, false, false, false }
+};
+
+bool canTransition(OrderStatus from, OrderStatus to) {
+    return ORDER_TRANSITIONS[from][to];
+}
+
+// Cancelled and returned orders no longer count towards a customer's spend.
+bool countsTowardSpend(OrderStatus s) {
+    return s != STATUS_CANCELLED && s != STATUS_RETURNED;
+}
+
+bool equalsIgnoreCase(const string& a, const string& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i)
+        if (tolower((unsigned char)a[i]) != tolower((unsigned char)b[i])) return false;
+    return true;
+}
+
+bool parseOrderStatus(const string& text, OrderStatus& out) {
+    for (int i = 0; i < STATUS_COUNT; ++i) {
+        if (equalsIgnoreCase(text, ORDER_STATUS_NAMES[i])) { out = (OrderStatus)i; return true; }
+    }
+    return false;
+}
+
+const int ORDER_EVENT_QUEUE_SIZE = 1024;   // must be a power of two
+const int ORDER_EVENT_BATCH = 64;
+const int ORDER_INDEX_BITS = 9;
+const int ORDER_INDEX_SLOTS = 1 << ORDER_INDEX_BITS;   // more than 2 * MAX_ORDERS
+
+struct OrderEvent {
+    int orderId;
+    OrderStatus status;
+};
+
+// Bounded lock-free MPMC ring (Vyukov). Each cell carries a sequence number,
+// so producers and consumers claim a slot with a single CAS on their index.
+class OrderEventQueue {
+    struct Cell {
+        atomic<size_t> sequence;
+        OrderEvent event;
+    };
+    Cell cells[ORDER_EVENT_QUEUE_SIZE];
+    char padBefore[64];
+    atomic<size_t> enqueuePos;
+    char padBetween[64];
+    atomic<size_t> dequeuePos;
+
+public:
+    OrderEventQueue() : enqueuePos(0), dequeuePos(0) {
+        for (int i = 0; i < ORDER_EVENT_QUEUE_SIZE; ++i) cells[i].sequence.store(i, memory_order_relaxed);
+    }
+
+    bool push(const OrderEvent& e) {
+        size_t pos = enqueuePos.load(memory_order_relaxed);
+        while (true) {
+            Cell& c = cells[pos & (ORDER_EVENT_QUEUE_SIZE - 1)];
+            size_t seq = c.sequence.load(memory_order_acquire);
+            ptrdiff_t diff = (ptrdiff_t)seq - (ptrdiff_t)pos;
+            if (diff == 0) {
+                if (enqueuePos.compare_exchange_weak(pos, pos + 1, memory_order_relaxed)) {
+                    c.event = e;
+                    c.sequence.store(pos + 1, memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = enqueuePos.load(memory_order_relaxed);
+            }
+        }
+    }
+
+    bool pop(OrderEvent& e) {
+        size_t pos = dequeuePos.load(memory_order_relaxed);
+        while (true) {
+            Cell& c = cells[pos & (ORDER_EVENT_QUEUE_SIZE - 1)];
+            size_t seq = c.sequence.load(memory_order_acquire);
+            ptrdiff_t diff = (ptrdiff_t)seq - (ptrdiff_t)(pos + 1);
+            if (diff == 0) {
+                if (dequeuePos.compare_exchange_weak(pos, pos + 1, memory_order_relaxed)) {
+                    e = c.event;
+                    c.sequence.store(pos + ORDER_EVENT_QUEUE_SIZE, memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = dequeuePos.load(memory_order_relaxed);
+            }
+        }
+    }
+};
+
 class Product {
 protected:
     int id;
@@ -84,6 +442,15 @@ public:
     }
 };
 
+// Builds the product subclass matching a category name, or NULL if unknown.
+Product* createProduct(int id, const string& name, const string& category, double price, const string& sub) {
+    if (equalsIgnoreCase(category, "Fashion")) return new FashionProduct(id, name, price, sub);
+    if (equalsIgnoreCase(category, "Education")) return new EducationProduct(id, name, price, sub);
+    if (equalsIgnoreCase(category, "Automobiles")) return new AutomobileProduct(id, name, price, sub);
+    if (equalsIgnoreCase(category, "Electronics")) return new ElectronicsProduct(id, name, price, sub);
+    return NULL;
+}
+
 class CartItem {
     Product* product;
     int quantity;
@@ -112,13 +479,13 @@ class Order {
     string deliveryType;
     double deliveryCharge;
     string paymentMethod;
-    string status;
+    OrderStatus status;
 
 public:
     Order()
         : orderId(0), customerUsername(""), deliveryAddress(""), itemsCount(0),
           totalCost(0.0), deliveryType("Normal"), deliveryCharge(0.0),
-          paymentMethod(""), status("Placed") {}
+          paymentMethod(""), status(STATUS_PLACED) {}
 
     void initialize(const string& uname, const string& addr, CartItem cart[],
                     int cartCount, const string& pMethod, const string& dType, double baseCost) {
@@ -134,16 +501,32 @@ public:
         deliveryType = dType;
         deliveryCharge = (dType == "Urgent") ? 500.0 : 0.0;
         totalCost = baseCost + deliveryCharge;
-        status = "Placed";
+        status = STATUS_PLACED;
+    }
+
+    // Rebuilds a historic order under its original id and status, and moves
+    // the id counter past it so new checkouts cannot reuse the id.
+    void restore(int id, const string& uname, const string& addr, CartItem cart[], int cartCount,
+                 const string& pMethod, const string& dType, double baseCost, OrderStatus s) {
+        int saved = nextOrderId;
+        nextOrderId = id;
+        initialize(uname, addr, cart, cartCount, pMethod, dType, baseCost);
+        if (saved > nextOrderId) nextOrderId = saved;
+        status = s;
     }
 
     int getId() const { return orderId; }
     string getUsername() const { return customerUsername; }
     string getAddress() const { return deliveryAddress; }
-    string getStatus() const { return status; }
+    OrderStatus getStatus() const { return status; }
+    string getStatusName() const { return ORDER_STATUS_NAMES[status]; }
     double getTotalCost() const { return totalCost; }
 
-    void setStatus(const string& s) { status = s; }
+    bool transitionTo(OrderStatus next) {
+        if (!canTransition(status, next)) return false;
+        status = next;
+        return true;
+    }
 
     void displayOrder() const {
         cout << "\n--- Order ID: " << orderId << " ---" << endl;
@@ -151,7 +534,7 @@ public:
         cout << "  Address: " << deliveryAddress << endl;
         cout << "  Delivery Type: " << deliveryType << " (" << (deliveryType == "Urgent" ? "3 days" : "5 days") << ")" << endl;
         cout << "  Payment: " << paymentMethod << endl;
-        cout << "  Status: " << status << endl;
+        cout << "  Status: " << ORDER_STATUS_NAMES[status] << endl;
         cout << "  Items:" << endl;
         for (int i = 0; i < itemsCount; ++i) {
             Product* p = items[i].getProduct();
@@ -189,10 +572,16 @@ class Customer : public User {
     CartItem shoppingCart[MAX_CART_ITEMS];
     int cartCount;
     NTSHOP* shopSystem;
+    int ordersCount;
+    double totalSpent;
 
 public:
     Customer(const string& u = "", const string& p = "", NTSHOP* shop = NULL)
-        : User(u, p, ""), cartCount(0), shopSystem(shop) {}
+        : User(u, p, ""), cartCount(0), shopSystem(shop), ordersCount(0), totalSpent(0.0) {}
+
+    int getOrdersCount() const { return ordersCount; }
+    double getTotalSpent() const { return totalSpent; }
+    void recordSpend(int orders, double amount) { ordersCount += orders; totalSpent += amount; }
 
     void startSession() override;
     void viewCart() const;
@@ -200,6 +589,8 @@ public:
     void viewOrderHistory() const;
     double calculateCartTotal() const;
     bool addToCart(Product* p, int q);
+    bool submitOrder(const string& paymentMethod, const string& deliveryType, int& orderId);
+    bool placeOrder(const string& paymentMethod, const string& deliveryType);
     void clearCart();
 };
 
@@ -210,8 +601,12 @@ public:
         : User(u, p, ""), shopSystem(shop) {}
     void startSession() override;
     void viewOrders() const;
-    void markOrderDelivered();
+    void updateOrderStatus();
+    void applyStatusFeed();
     void searchCustomer() const;
+    void viewMetrics() const;
+    void dumpMetrics() const;
+    void importData();
 };
 
 class NTSHOP {
@@ -221,9 +616,24 @@ class NTSHOP {
     int userCount;
     Order allOrders[MAX_ORDERS];
     int orderCount;
+    int orderIndex[ORDER_INDEX_SLOTS];
+    int statusCounts[STATUS_COUNT];
+    OrderEventQueue statusEvents;
+
+    // Fibonacci hashing: the top bits of the product depend on every bit of
+    // the id, so ids sharing their low bits still spread across the table.
+    static int orderSlot(int id) {
+        return (int)(((uint32_t)id * 2654435761u) >> (32 - ORDER_INDEX_BITS));
+    }
+
+    Customer* findCustomer(const string& uname) const {
+        return dynamic_cast<Customer*>(lookupUser(uname));
+    }
 
 public:
     NTSHOP() : productCount(0), userCount(0), orderCount(0) {
+        for (int i = 0; i < ORDER_INDEX_SLOTS; ++i) orderIndex[i] = -1;
+        for (int i = 0; i < STATUS_COUNT; ++i) statusCounts[i] = 0;
         allUsers[userCount++] = new Admin("admin", "admin123", this);
         addProduct(new FashionProduct(1, "Slim Fit Jeans", 3500.0, "Male Clothings"));
         addProduct(new FashionProduct(2, "Leather Handbag", 6800.0, "Female Accessories"));
@@ -244,12 +654,19 @@ public:
         return true;
     }
 
-    Product* getProductById(int id) const {
+    // lookupProduct/lookupUser are the untimed lookups for internal and bulk
+    // paths; getProductById/findUser are the timed entry points.
+    Product* lookupProduct(int id) const {
         for (int i = 0; i < productCount; ++i)
             if (allProducts[i]->getId() == id) return allProducts[i];
         return NULL;
     }
 
+    Product* getProductById(int id) const {
+        SHOP_METRIC_SCOPE(OP_GET_PRODUCT);
+        return lookupProduct(id);
+    }
+
     void displayAllProductsByCategory(const string& cat) const {
         bool found = false;
         cout << "\n--- Products in " << cat << " ---" << endl;
@@ -270,27 +687,107 @@ public:
     }
 
     bool registerCustomer(const string& u, const string& p) {
-        if (findUser(u) != NULL) return false;
+        if (lookupUser(u) != NULL) return false;
         if (userCount >= MAX_USERS) return false;
         allUsers[userCount++] = new Customer(u, p, this);
         return true;
     }
 
-    User* findUser(const string& uname) const {
+    User* lookupUser(const string& uname) const {
         for (int i = 0; i < userCount; ++i)
             if (allUsers[i]->getUsername() == uname) return allUsers[i];
         return NULL;
     }
 
-    bool addOrder(const Order& o) {
+    User* findUser(const string& uname) const {
+        SHOP_METRIC_SCOPE(OP_FIND_USER);
+        return lookupUser(uname);
+    }
+
+    // Stores an order and updates the id index, status counts and the
+    // customer's spend totals. Order ids must be unique.
+    bool insertOrder(const Order& o) {
         if (orderCount >= MAX_ORDERS) return false;
+        if (findOrderIndex(o.getId()) >= 0) return false;
+        int slot = orderSlot(o.getId());
+        while (orderIndex[slot] >= 0) slot = (slot + 1) & (ORDER_INDEX_SLOTS - 1);
+        orderIndex[slot] = orderCount;
         allOrders[orderCount++] = o;
+        statusCounts[o.getStatus()]++;
+        Customer* c = findCustomer(o.getUsername());
+        if (c && countsTowardSpend(o.getStatus())) c->recordSpend(1, o.getTotalCost());
+        return true;
+    }
+
+    bool addOrder(const Order& o) {
+        SHOP_METRIC_SCOPE(OP_ADD_ORDER);
+        return insertOrder(o);
+    }
+
+    void announceOrder(int id) const {
         cout << "\n\n********************************************************" << endl;
-        cout << "    Order Placed Successfully! Order ID: " << allOrders[orderCount-1].getId() << endl;
+        cout << "    Order Placed Successfully! Order ID: " << id << endl;
         cout << "********************************************************\n" << endl;
+    }
+
+    int findOrderIndex(int id) const {
+        for (int slot = orderSlot(id); orderIndex[slot] >= 0; slot = (slot + 1) & (ORDER_INDEX_SLOTS - 1))
+            if (allOrders[orderIndex[slot]].getId() == id) return orderIndex[slot];
+        return -1;
+    }
+
+    Order* findOrder(int id) {
+        int idx = findOrderIndex(id);
+        return idx < 0 ? NULL : &allOrders[idx];
+    }
+
+    bool transitionOrder(int id, OrderStatus next) {
+        Order* o = findOrder(id);
+        if (!o) return false;
+        OrderStatus prev = o->getStatus();
+        if (!o->transitionTo(next)) return false;
+        statusCounts[prev]--;
+        statusCounts[next]++;
+        if (countsTowardSpend(prev) != countsTowardSpend(next)) {
+            Customer* c = findCustomer(o->getUsername());
+            if (c) {
+                if (countsTowardSpend(next)) c->recordSpend(1, o->getTotalCost());
+                else c->recordSpend(-1, -o->getTotalCost());
+            }
+        }
         return true;
     }
 
+    // Safe to call from any thread; the event is applied by the next
+    // applyPendingEvents(). Returns false when the queue is full.
+    bool postStatusEvent(int id, OrderStatus next) {
+        OrderEvent e;
+        e.orderId = id;
+        e.status = next;
+        return statusEvents.push(e);
+    }
+
+    // Drains the event queue ORDER_EVENT_BATCH events at a time, in the order
+    // they were posted. Returns the number applied; events for unknown orders
+    // or invalid transitions are dropped and counted in rejected.
+    int applyPendingEvents(int& rejected) {
+        OrderEvent batch[ORDER_EVENT_BATCH];
+        int applied = 0;
+        rejected = 0;
+        while (true) {
+            int n = 0;
+            while (n < ORDER_EVENT_BATCH && statusEvents.pop(batch[n])) n++;
+            if (n == 0) break;
+            for (int i = 0; i < n; ++i) {
+                if (transitionOrder(batch[i].orderId, batch[i].status)) applied++;
+                else rejected++;
+            }
+        }
+        return applied;
+    }
+
+    int getStatusCount(OrderStatus s) const { return statusCounts[s]; }
+
     int getOrderCount() const { return orderCount; }
     const Order& getOrderAt(int idx) const { return allOrders[idx]; }
     Order& getOrderAt(int idx) { return allOrders[idx]; }
@@ -298,18 +795,19 @@ public:
     void displayAllOrders() const {
         if (orderCount == 0) { cout << "\nNo orders placed yet." << endl; return; }
         for (int i = 0; i < orderCount; ++i) allOrders[i].displayOrder();
+        cout << "\n--- Orders by Status ---" << endl;
+        for (int s = 0; s < STATUS_COUNT; ++s)
+            cout << "  " << ORDER_STATUS_NAMES[s] << ": " << statusCounts[s] << endl;
     }
 
     void displayDeliveredOrders() const {
         cout << "\n--- Delivered Orders ---" << endl;
-        bool found = false;
-        for (int i = 0; i < orderCount; ++i) {
-            if (allOrders[i].getStatus() == "Delivered") {
-                allOrders[i].displayOrder();
-                found = true;
-            }
+        if (statusCounts[STATUS_DELIVERED] == 0) {
+            cout << "No delivered orders found." << endl;
+            return;
         }
-        if (!found) cout << "No delivered orders found." << endl;
+        for (int i = 0; i < orderCount; ++i)
+            if (allOrders[i].getStatus() == STATUS_DELIVERED) allOrders[i].displayOrder();
     }
 
     User** getUsersArray() { return allUsers; }
@@ -355,6 +853,25 @@ void Customer::clearCart() {
     cartCount = 0;
 }
 
+// The timed part of checkout: builds and stores the order, no console output.
+bool Customer::submitOrder(const string& paymentMethod, const string& deliveryType, int& orderId) {
+    SHOP_METRIC_SCOPE(OP_CHECKOUT);
+    Order newOrder;
+    newOrder.initialize(this->username, this->address, shoppingCart, cartCount, paymentMethod, deliveryType, calculateCartTotal());
+    if (!shopSystem->addOrder(newOrder)) return false;
+    if (paymentMethod == "Advance Payment") shopSystem->transitionOrder(newOrder.getId(), STATUS_PAID);
+    clearCart();
+    orderId = newOrder.getId();
+    return true;
+}
+
+bool Customer::placeOrder(const string& paymentMethod, const string& deliveryType) {
+    int orderId;
+    if (!submitOrder(paymentMethod, deliveryType, orderId)) return false;
+    shopSystem->announceOrder(orderId);
+    return true;
+}
+
 void Customer::checkout() {
     if (cartCount == 0) {
         cout << "\n Cannot checkout. Your cart is empty." << endl;
@@ -390,7 +907,6 @@ void Customer::checkout() {
 
     int deliveryChoice;
     string deliveryType;
-    double baseTotal = calculateCartTotal();
     cout << "\nSelect Delivery Type:" << endl;
     cout << "1. Normal Delivery (5 days, No extra charge)" << endl;
     cout << "2. Urgent Delivery (3 days, PKR 500 extra charge)" << endl;
@@ -418,12 +934,7 @@ void Customer::checkout() {
         return;
     }
 
-    Order newOrder;
-    newOrder.initialize(this->username, this->address, shoppingCart, cartCount, paymentMethod, deliveryType, baseTotal);
-
-    if (shopSystem->addOrder(newOrder)) {
-        clearCart();
-    } else {
+    if (!placeOrder(paymentMethod, deliveryType)) {
         cout << "Failed to add order to system ." << endl;
     }
 }
@@ -516,29 +1027,74 @@ void Admin::viewOrders() const {
     shopSystem->displayAllOrders();
 }
 
-void Admin::markOrderDelivered() {
+void Admin::updateOrderStatus() {
     int id;
-    cout << "Enter Order ID to mark as delivered: ";
+    cout << "Enter Order ID to update: ";
     if (!(cin >> id)) {
         cin.clear(); cin.ignore(10000, '\n');
         cout << "Invalid ID." << endl;
         return;
     }
-    int oc = shopSystem->getOrderCount();
-    for (int i = 0; i < oc; ++i) {
-        Order& o = shopSystem->getOrderAt(i);
-        if (o.getId() == id) {
-            if (o.getStatus() == "Placed") {
-                o.setStatus("Delivered");
-                cout << " Order ID " << id << " marked as 'Delivered'." << endl;
-                return;
-            } else {
-                cout << " Order ID " << id << " is already " << o.getStatus() << "." << endl;
-                return;
-            }
+    Order* o = shopSystem->findOrder(id);
+    if (!o) {
+        cout << " Order ID " << id << " not found." << endl;
+        return;
+    }
+    cout << "Current status: " << o->getStatusName() << endl;
+    cout << "New status: 1) Paid 2) Shipped 3) Delivered 4) Cancelled 5) Returned: ";
+    int statusChoice;
+    if (!(cin >> statusChoice) || statusChoice < STATUS_PAID || statusChoice > STATUS_RETURNED) {
+        cin.clear(); cin.ignore(10000, '\n');
+        cout << "Invalid status." << endl;
+        return;
+    }
+    OrderStatus next = (OrderStatus)statusChoice;
+    OrderStatus prev = o->getStatus();
+    if (shopSystem->transitionOrder(id, next)) {
+        cout << " Order ID " << id << " marked as '" << ORDER_STATUS_NAMES[next] << "'." << endl;
+    } else {
+        cout << " Order ID " << id << " cannot move from " << ORDER_STATUS_NAMES[prev]
+             << " to " << ORDER_STATUS_NAMES[next] << "." << endl;
+    }
+}
+
+// Feed lines are "<orderId> <status>" or "<orderId>,<status>", as sent by
+// courier and payment partners. Blank or whitespace-only lines and '#' comments
+// are skipped; lines with anything after the status count as malformed.
+void Admin::applyStatusFeed() {
+    string fileName;
+    cout << "Enter status feed file name: ";
+    cin >> fileName;
+    ifstream in(fileName.c_str());
+    if (!in) {
+        cout << " Could not open '" << fileName << "'." << endl;
+        return;
+    }
+
+    int applied = 0, rejected = 0, malformed = 0, batchRejected = 0;
+    string line;
+    while (getline(in, line)) {
+        size_t first = line.find_first_not_of(" \t\r");
+        if (first == string::npos || line[first] == '#') continue;
+        for (size_t k = 0; k < line.size(); ++k) if (line[k] == ',') line[k] = ' ';
+        istringstream fields(line);
+        int id;
+        string statusText, extra;
+        OrderStatus next;
+        if (!(fields >> id >> statusText) || !parseOrderStatus(statusText, next) || (fields >> extra)) {
+            malformed++;
+            continue;
+        }
+        while (!shopSystem->postStatusEvent(id, next)) {
+            applied += shopSystem->applyPendingEvents(batchRejected);
+            rejected += batchRejected;
         }
     }
-    cout << " Order ID " << id << " not found." << endl;
+    applied += shopSystem->applyPendingEvents(batchRejected);
+    rejected += batchRejected;
+
+    cout << " Status feed applied: " << applied << " updated, " << rejected
+         << " rejected (unknown order or invalid transition), " << malformed << " malformed." << endl;
 }
 
 void Admin::searchCustomer() const {
@@ -581,19 +1137,8 @@ void Admin::searchCustomer() const {
                 cout << "Found Customer: " << customer->getUsername() << endl;
                 cout << "  - Last Known Address: " << customer->getAddress() << endl;
 
-                double totalSpent = 0.0;
-                int ordersCount = 0;
-                int oc = shopSystem->getOrderCount();
-                for (int j = 0; j < oc; ++j) {
-                    const Order& o = shopSystem->getOrderAt(j);
-                    if (o.getUsername() == customer->getUsername() && o.getStatus() != "Cancelled") {
-                        totalSpent += o.getTotalCost();
-                        ordersCount++;
-                    }
-                }
-
-                cout << "  - Total Orders Placed : " << ordersCount << endl;
-                cout << "  - Total Amount Shopped: PKR " << fixed << setprecision(2) << totalSpent << endl;
+                cout << "  - Total Orders Placed : " << customer->getOrdersCount() << endl;
+                cout << "  - Total Amount Shopped: PKR " << fixed << setprecision(2) << customer->getTotalSpent() << endl;
             }
         }
     }
@@ -603,33 +1148,607 @@ void Admin::searchCustomer() const {
     }
 }
 
+void Admin::viewMetrics() const {
+    Metrics::report(cout);
+}
+
+void Admin::dumpMetrics() const {
+    string fileName;
+    cout << "Enter file name to dump metrics to: ";
+    cin >> fileName;
+    ofstream out(fileName.c_str(), ios::app);
+    if (!out) {
+        cout << " Could not open '" << fileName << "' for writing." << endl;
+        return;
+    }
+    Metrics::report(out);
+    cout << " Metrics written to '" << fileName << "'." << endl;
+}
+
 void Admin::startSession() {
     int choice;
     while (true) {
         cout << "\n--- Welcome, Admin (" << username << ") ---" << endl;
         cout << "1. View All Orders" << endl;
         cout << "2. View Delivered Orders" << endl;
-        cout << "3. Mark Order as Delivered" << endl;
+        cout << "3. Update Order Status" << endl;
         cout << "4. Search Customer Information" << endl;
-        cout << "5. Logout" << endl;
+        cout << "5. View Performance Metrics" << endl;
+        cout << "6. Dump Metrics to File" << endl;
+        cout << "7. Apply Status Update Feed" << endl;
+        cout << "8. Import Data From File" << endl;
+        cout << "9. Logout" << endl;
         cout << "Enter choice: ";
         if (!(cin >> choice)) {
             cin.clear(); cin.ignore(10000, '\n');
             cout << "Invalid input. Please try again." << endl;
             continue;
         }
-        if (choice == 5) break;
+        if (choice == 9) break;
 
         switch (choice) {
             case 1: viewOrders(); break;
             case 2: shopSystem->displayDeliveredOrders(); break;
-            case 3: markOrderDelivered(); break;
+            case 3: updateOrderStatus(); break;
             case 4: searchCustomer(); break;
+            case 5: viewMetrics(); break;
+            case 6: dumpMetrics(); break;
+            case 7: applyStatusFeed(); break;
+            case 8: importData(); break;
             default: cout << "Invalid option." << endl;
         }
     }
 }
 
+const size_t IMPORT_CHUNK_BYTES = 4 * 1024 * 1024;
+const int IMPORT_MAX_THREADS = 8;
+// Historic order ids above this are rejected, leaving room for new checkout ids.
+const int MAX_HISTORIC_ORDER_ID = 999999999;
+const size_t IMPORT_LINES_PER_THREAD = 2048;
+
+enum ImportKind { IMPORT_PRODUCTS, IMPORT_CUSTOMERS, IMPORT_ORDERS };
+const char* const IMPORT_KIND_NAMES[] = { "products", "customers", "orders" };
+
+// One parsed input row. Only the fields for the import kind are filled in.
+struct ImportRow {
+    bool valid;
+    int id;
+    string name, category, subCategory;
+    double price;
+    string username, password, address;
+    int itemIds[MAX_ORDER_ITEMS];
+    int itemQty[MAX_ORDER_ITEMS];
+    int itemCount;
+    string paymentMethod, deliveryType;
+    OrderStatus status;
+
+    ImportRow() : valid(false), id(0), price(0.0), itemCount(0), status(STATUS_PLACED) {}
+};
+
+struct ImportStats {
+    long long rows;
+    long long inserted;
+    long long duplicates;
+    long long invalid;
+    long long overCapacity;
+    double bytes;
+    double seconds;
+
+    ImportStats() : rows(0), inserted(0), duplicates(0), invalid(0), overCapacity(0), bytes(0), seconds(0) {}
+};
+
+void trimField(string& value) {
+    size_t b = value.find_first_not_of(" \t");
+    size_t e = value.find_last_not_of(" \t");
+    if (b == string::npos) value.clear();
+    else if (b > 0 || e + 1 < value.size()) value = value.substr(b, e - b + 1);
+}
+
+// Splits one CSV line; every cell (header or data) is trimmed of spaces and tabs.
+bool splitCsvLine(const char* p, const char* end, vector<string>& out) {
+    out.clear();
+    string value;
+    bool quoted = false;
+    for (; p < end; ++p) {
+        char c = *p;
+        if (quoted) {
+            if (c == '"') {
+                if (p + 1 < end && p[1] == '"') { value += '"'; ++p; }
+                else quoted = false;
+            } else {
+                value += c;
+            }
+        } else if (c == '"' && value.find_first_not_of(" \t") == string::npos) {
+            // An opening quote may follow padding; the padding is dropped.
+            value.clear();
+            quoted = true;
+        } else if (c == ',') {
+            trimField(value);
+            out.push_back(value);
+            value.clear();
+        } else {
+            value += c;
+        }
+    }
+    if (quoted) return false;
+    trimField(value);
+    out.push_back(value);
+    return true;
+}
+
+bool readHex4(const char* p, const char* end, unsigned& out) {
+    if (end - p < 4) return false;
+    out = 0;
+    for (int i = 0; i < 4; ++i) {
+        char c = p[i];
+        unsigned digit;
+        if (c >= '0' && c <= '9') digit = c - '0';
+        else if (c >= 'a' && c <= 'f') digit = c - 'a' + 10;
+        else if (c >= 'A' && c <= 'F') digit = c - 'A' + 10;
+        else return false;
+        out = out * 16 + digit;
+    }
+    return true;
+}
+
+void appendUtf8(string& out, unsigned cp) {
+    if (cp < 0x80) {
+        out += (char)cp;
+    } else if (cp < 0x800) {
+        out += (char)(0xC0 | (cp >> 6));
+        out += (char)(0x80 | (cp & 0x3F));
+    } else if (cp < 0x10000) {
+        out += (char)(0xE0 | (cp >> 12));
+        out += (char)(0x80 | ((cp >> 6) & 0x3F));
+        out += (char)(0x80 | (cp & 0x3F));
+    } else {
+        out += (char)(0xF0 | (cp >> 18));
+        out += (char)(0x80 | ((cp >> 12) & 0x3F));
+        out += (char)(0x80 | ((cp >> 6) & 0x3F));
+        out += (char)(0x80 | (cp & 0x3F));
+    }
+}
+
+// Parses one flat NDJSON object. String values are unescaped to UTF-8;
+// numbers and true/false are kept as their literal text, and a null value
+// drops the key as if it were absent. Nested values are rejected.
+bool parseJsonObject(const char* p, const char* end, vector<string>& keys, vector<string>& values) {
+    keys.clear();
+    values.clear();
+    while (p < end && isspace((unsigned char)*p)) ++p;
+    if (p == end || *p++ != '{') return false;
+    bool expectKey = true;
+    bool quoted = false;
+    string token;
+    while (true) {
+        while (p < end && isspace((unsigned char)*p)) ++p;
+        if (p == end) return false;
+        if (*p == '}' && (keys.empty() || !expectKey)) { ++p; break; }
+        if (*p == '"') {
+            token.clear();
+            for (++p; p < end && *p != '"'; ++p) {
+                if (*p != '\\') { token += *p; continue; }
+                if (++p == end) return false;
+                switch (*p) {
+                    case '"': case '\\': case '/': token += *p; break;
+                    case 'b': token += '\b'; break;
+                    case 'f': token += '\f'; break;
+                    case 'n': token += '\n'; break;
+                    case 't': token += '\t'; break;
+                    case 'r': token += '\r'; break;
+                    case 'u': {
+                        unsigned cp, low;
+                        if (!readHex4(p + 1, end, cp)) return false;
+                        p += 4;
+                        if (cp >= 0xDC00 && cp <= 0xDFFF) return false;
+                        if (cp >= 0xD800 && cp <= 0xDBFF) {
+                            if (end - p < 7 || p[1] != '\\' || p[2] != 'u' || !readHex4(p + 3, end, low)
+                                || low < 0xDC00 || low > 0xDFFF)
+                                return false;
+                            cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+                            p += 6;
+                        }
+                        appendUtf8(token, cp);
+                        break;
+                    }
+                    default: return false;
+                }
+            }
+            if (p == end) return false;
+            ++p;
+            quoted = true;
+        } else if (!expectKey && *p != '{' && *p != '[') {
+            const char* start = p;
+            while (p < end && *p != ',' && *p != '}' && !isspace((unsigned char)*p)) ++p;
+            token.assign(start, p);
+            quoted = false;
+        } else {
+            return false;
+        }
+        while (p < end && isspace((unsigned char)*p)) ++p;
+        if (expectKey) {
+            if (p == end || *p++ != ':') return false;
+            keys.push_back(token);
+            expectKey = false;
+        } else {
+            if (!quoted && token == "null") keys.pop_back();
+            else values.push_back(token);
+            if (p < end && *p == ',') { ++p; expectKey = true; }
+            else if (p == end || *p != '}') return false;
+        }
+    }
+    while (p < end && isspace((unsigned char)*p)) ++p;
+    return p == end;
+}
+
+bool parseIntField(const string& text, int& out) {
+    if (text.empty()) return false;
+    char* stop;
+    errno = 0;
+    long v = strtol(text.c_str(), &stop, 10);
+    if (*stop != '\0' || errno == ERANGE || v < INT_MIN || v > INT_MAX) return false;
+    out = (int)v;
+    return true;
+}
+
+// Streams a CSV (with header row) or NDJSON file into NTSHOP. The file is
+// read in IMPORT_CHUNK_BYTES chunks and its lines are handled in batches of
+// at most batchSize rows: each batch is parsed on several threads, then
+// validated, deduplicated and inserted in file order on the calling thread.
+// Memory use depends on the chunk and batch sizes, not the file size.
+// Records are split on newlines before parsing, so a quoted CSV field
+// cannot contain a newline: such a record becomes two invalid rows.
+class ShopImporter {
+    NTSHOP* shop;
+    ImportKind kind;
+    bool formatKnown;
+    bool ndjson;
+    vector<string> header;
+    ImportStats stats;
+    size_t batchThreads;
+    size_t batchSize;
+    vector<size_t> starts, ends;
+    vector<ImportRow> rows;
+
+    static bool field(const vector<string>& keys, const vector<string>& values,
+                      const char* name, string& out) {
+        for (size_t i = 0; i < keys.size() && i < values.size(); ++i) {
+            if (equalsIgnoreCase(keys[i], name)) { out = values[i]; return true; }
+        }
+        return false;
+    }
+
+    // ownKeys and values are scratch buffers reused across a worker's lines.
+    bool parseLine(const char* begin, const char* end, ImportRow& row,
+                   vector<string>& ownKeys, vector<string>& values) const {
+        if (ndjson) {
+            if (!parseJsonObject(begin, end, ownKeys, values)) return false;
+        } else if (!splitCsvLine(begin, end, values)) {
+            return false;
+        }
+        const vector<string>& keys = ndjson ? ownKeys : header;
+        string text;
+
+        if (kind == IMPORT_PRODUCTS) {
+            if (!field(keys, values, "id", text) || !parseIntField(text, row.id) || row.id <= 0) return false;
+            if (!field(keys, values, "name", row.name) || row.name.empty()) return false;
+            if (!field(keys, values, "category", row.category)) return false;
+            if (!field(keys, values, "price", text) || text.empty()) return false;
+            char* stop;
+            row.price = strtod(text.c_str(), &stop);
+            if (*stop != '\0' || !isfinite(row.price) || row.price < 0) return false;
+            if (!field(keys, values, "subcategory", row.subCategory) || row.subCategory.empty())
+                row.subCategory = "General";
+        } else if (kind == IMPORT_CUSTOMERS) {
+            if (!field(keys, values, "username", row.username) || row.username.empty()) return false;
+            if (!field(keys, values, "password", row.password) || row.password.empty()) return false;
+            field(keys, values, "address", row.address);
+        } else {
+            if (!field(keys, values, "id", text) || !parseIntField(text, row.id) || row.id <= 0 || row.id > MAX_HISTORIC_ORDER_ID)
+                return false;
+            if (!field(keys, values, "username", row.username) || row.username.empty()) return false;
+            field(keys, values, "address", row.address);
+
+            // items: "productId:quantity;productId:quantity"
+            if (!field(keys, values, "items", text)) return false;
+            istringstream items(text);
+            string item;
+            while (getline(items, item, ';')) {
+                size_t colon = item.find(':');
+                if (colon == string::npos || row.itemCount >= MAX_ORDER_ITEMS) return false;
+                int& pid = row.itemIds[row.itemCount];
+                int& qty = row.itemQty[row.itemCount];
+                if (!parseIntField(item.substr(0, colon), pid) || !parseIntField(item.substr(colon + 1), qty) || qty <= 0)
+                    return false;
+                row.itemCount++;
+            }
+            if (row.itemCount == 0) return false;
+
+            row.paymentMethod = "Cash on Delivery (COD)";
+            if (field(keys, values, "payment", text) && (equalsIgnoreCase(text, "Advance") || equalsIgnoreCase(text, "Advance Payment")))
+                row.paymentMethod = "Advance Payment";
+            row.deliveryType = (field(keys, values, "delivery", text) && equalsIgnoreCase(text, "Urgent")) ? "Urgent" : "Normal";
+            if (field(keys, values, "status", text) && !text.empty() && !parseOrderStatus(text, row.status)) return false;
+        }
+        return true;
+    }
+
+    void parseRange(const char* data, const vector<size_t>* starts, const vector<size_t>* ends,
+                    vector<ImportRow>* rows, size_t from, size_t to) const {
+        vector<string> keys, values;
+        for (size_t i = from; i < to; ++i) {
+            ImportRow& row = (*rows)[i];
+            row = ImportRow();
+            row.valid = parseLine(data + (*starts)[i], data + (*ends)[i], row, keys, values);
+        }
+    }
+
+    // Rows past capacity are only checked against what is already stored, so
+    // duplicates of rejected rows count as over capacity, not as duplicates.
+    void insertRow(const ImportRow& row) {
+        if (!row.valid) { stats.invalid++; return; }
+
+        if (kind == IMPORT_PRODUCTS) {
+            if (shop->lookupProduct(row.id)) { stats.duplicates++; return; }
+            Product* p = createProduct(row.id, row.name, row.category, row.price, row.subCategory);
+            if (!p) { stats.invalid++; return; }
+            if (!shop->addProduct(p)) { delete p; stats.overCapacity++; return; }
+        } else if (kind == IMPORT_CUSTOMERS) {
+            if (shop->lookupUser(row.username)) { stats.duplicates++; return; }
+            if (!shop->registerCustomer(row.username, row.password)) { stats.overCapacity++; return; }
+            if (!row.address.empty()) shop->lookupUser(row.username)->setAddress(row.address);
+        } else {
+            if (shop->findOrderIndex(row.id) >= 0) { stats.duplicates++; return; }
+            Customer* c = dynamic_cast<Customer*>(shop->lookupUser(row.username));
+            if (!c) { stats.invalid++; return; }
+            CartItem cart[MAX_ORDER_ITEMS];
+            double baseCost = 0.0;
+            for (int i = 0; i < row.itemCount; ++i) {
+                Product* p = shop->lookupProduct(row.itemIds[i]);
+                if (!p) { stats.invalid++; return; }
+                cart[i].set(p, row.itemQty[i]);
+                baseCost += cart[i].getTotalPrice();
+            }
+            if (shop->getOrderCount() >= MAX_ORDERS) { stats.overCapacity++; return; }
+            Order o;
+            o.restore(row.id, row.username, row.address.empty() ? c->getAddress() : row.address,
+                      cart, row.itemCount, row.paymentMethod, row.deliveryType, baseCost, row.status);
+            if (!shop->insertOrder(o)) { stats.overCapacity++; return; }
+        }
+        stats.inserted++;
+    }
+
+    // Parses the pending batch of lines and inserts the rows, then empties it.
+    void flushBatch(const char* data) {
+        size_t lineCount = starts.size();
+        if (lineCount == 0) return;
+        size_t threadCount = lineCount / IMPORT_LINES_PER_THREAD + 1;
+        if (threadCount > batchThreads) threadCount = batchThreads;
+
+        vector<thread> workers;
+        size_t per = (lineCount + threadCount - 1) / threadCount;
+        for (size_t t = 1; t < threadCount; ++t) {
+            size_t from = min(lineCount, t * per), to = min(lineCount, from + per);
+            workers.push_back(thread(&ShopImporter::parseRange, this, data, &starts, &ends, &rows, from, to));
+        }
+        parseRange(data, &starts, &ends, &rows, 0, min(lineCount, per));
+        for (size_t t = 0; t < workers.size(); ++t) workers[t].join();
+
+        for (size_t i = 0; i < lineCount; ++i) insertRow(rows[i]);
+        stats.rows += lineCount;
+        starts.clear();
+        ends.clear();
+    }
+
+    // Parses every non-blank line in data[0, length) and inserts the rows.
+    // The first non-blank line of the file decides the format: '{' means
+    // NDJSON, anything else is taken as the CSV header.
+    void processLines(const char* data, size_t length) {
+        size_t pos = 0;
+        while (pos < length) {
+            const char* nl = (const char*)memchr(data + pos, '\n', length - pos);
+            size_t stop = nl ? (size_t)(nl - data) : length;
+            size_t lineEnd = stop;
+            if (lineEnd > pos && data[lineEnd - 1] == '\r') lineEnd--;
+            size_t first = pos;
+            while (first < lineEnd && isspace((unsigned char)data[first])) first++;
+            if (first < lineEnd) {
+                if (!formatKnown) {
+                    formatKnown = true;
+                    ndjson = data[first] == '{';
+                }
+                if (!ndjson && header.empty()) {
+                    splitCsvLine(data + pos, data + lineEnd, header);
+                } else {
+                    starts.push_back(pos);
+                    ends.push_back(lineEnd);
+                    if (starts.size() == batchSize) flushBatch(data);
+                }
+            }
+            pos = stop + 1;
+        }
+        flushBatch(data);
+    }
+
+public:
+    ShopImporter(NTSHOP* s, ImportKind k) : shop(s), kind(k), formatKnown(false), ndjson(false) {
+        batchThreads = thread::hardware_concurrency();
+        if (batchThreads == 0) batchThreads = 1;
+        if (batchThreads > (size_t)IMPORT_MAX_THREADS) batchThreads = IMPORT_MAX_THREADS;
+        batchSize = IMPORT_LINES_PER_THREAD * batchThreads;
+        starts.reserve(batchSize);
+        ends.reserve(batchSize);
+        rows.resize(batchSize);
+    }
+
+    bool importFile(const string& fileName) {
+        ifstream in(fileName.c_str(), ios::binary);
+        if (!in) return false;
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+        string buffer;
+        size_t carried = 0;
+        bool firstChunk = true;
+        bool skippingLine = false;
+        while (true) {
+            buffer.resize(carried + IMPORT_CHUNK_BYTES);
+            in.read(&buffer[carried], IMPORT_CHUNK_BYTES);
+            size_t got = (size_t)in.gcount();
+            stats.bytes += got;
+            size_t length = carried + got;
+            // Spreadsheet exports often start with a UTF-8 byte order mark.
+            if (firstChunk && length >= 3 && buffer.compare(0, 3, "\xEF\xBB\xBF") == 0) {
+                buffer.erase(0, 3);
+                length -= 3;
+                got -= 3;
+            }
+            firstChunk = false;
+            if (got == 0) {
+                if (length > 0 && !skippingLine) processLines(buffer.data(), length);
+                break;
+            }
+            // Discard the rest of an overlong line up to its newline.
+            size_t begin = 0;
+            if (skippingLine) {
+                const char* nl = (const char*)memchr(buffer.data(), '\n', length);
+                if (!nl) {
+                    carried = 0;
+                    continue;
+                }
+                begin = (size_t)(nl - buffer.data()) + 1;
+                skippingLine = false;
+            }
+            // Only complete lines are parsed; the tail waits for the next chunk.
+            size_t cut = buffer.rfind('\n', length - 1);
+            size_t tail = (cut == string::npos || cut < begin) ? begin : cut + 1;
+            if (tail > begin) processLines(buffer.data() + begin, tail - begin);
+            carried = length - tail;
+            // A line may not exceed IMPORT_CHUNK_BYTES, so the buffer stays bounded.
+            if (carried >= IMPORT_CHUNK_BYTES) {
+                stats.rows++;
+                stats.invalid++;
+                skippingLine = true;
+                carried = 0;
+                continue;
+            }
+            buffer.erase(0, tail);
+        }
+
+        stats.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        return true;
+    }
+
+    const ImportStats& getStats() const { return stats; }
+
+    void report(ostream& out) const {
+        double secs = stats.seconds > 0 ? stats.seconds : 1e-9;
+        out << "\n--- Import Summary (" << IMPORT_KIND_NAMES[kind] << ", " << (ndjson ? "NDJSON" : "CSV") << ") ---" << endl;
+        out << "  Rows read      : " << stats.rows << endl;
+        out << "  Inserted       : " << stats.inserted << endl;
+        out << "  Duplicates     : " << stats.duplicates << endl;
+        out << "  Invalid        : " << stats.invalid << endl;
+        out << "  Over capacity  : " << stats.overCapacity << endl;
+        out << "  Time           : " << fixed << setprecision(3) << stats.seconds << " s" << endl;
+        out << "  Throughput     : " << setprecision(0) << stats.rows / secs << " rows/s, "
+            << setprecision(2) << stats.bytes / (1024.0 * 1024.0) / secs << " MB/s" << endl;
+        out << "--------------------------------" << endl;
+    }
+};
+
+void Admin::importData() {
+    int kindChoice;
+    cout << "Import: 1) Products 2) Customers 3) Orders: ";
+    if (!(cin >> kindChoice) || kindChoice < 1 || kindChoice > 3) {
+        cin.clear(); cin.ignore(10000, '\n');
+        cout << "Invalid choice." << endl;
+        return;
+    }
+    string fileName;
+    cout << "Enter CSV or NDJSON file name: ";
+    cin >> fileName;
+    ShopImporter importer(shopSystem, (ImportKind)(kindChoice - 1));
+    if (!importer.importFile(fileName)) {
+        cout << " Could not open '" << fileName << "'." << endl;
+        return;
+    }
+    importer.report(cout);
+}
+
+// Measures queued status transitions: each round fills a fresh shop with
+// MAX_ORDERS orders, then posts and applies Paid -> Shipped -> Delivered ->
+// Returned for every order. Only posting and applying are timed.
+void runTransitionBenchmark(int rounds) {
+    const OrderStatus path[] = { STATUS_PAID, STATUS_SHIPPED, STATUS_DELIVERED, STATUS_RETURNED };
+    const int pathLength = 4;
+    double seconds = 0.0;
+    long long applied = 0, rejected = 0;
+    bool consistent = true;
+
+    for (int r = 0; r < rounds; ++r) {
+        NTSHOP* shop = new NTSHOP();
+        shop->registerCustomer("bench", "bench");
+        CartItem cart[1];
+        cart[0].set(shop->lookupProduct(1), 1);
+        for (int i = 0; i < MAX_ORDERS; ++i) {
+            Order o;
+            o.initialize("bench", "Bench Street", cart, 1, "Cash on Delivery (COD)", "Normal", cart[0].getTotalPrice());
+            shop->insertOrder(o);
+        }
+
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        for (int step = 0; step < pathLength; ++step) {
+            for (int i = 0; i < shop->getOrderCount(); ++i)
+                shop->postStatusEvent(shop->getOrderAt(i).getId(), path[step]);
+            int batchRejected = 0;
+            applied += shop->applyPendingEvents(batchRejected);
+            rejected += batchRejected;
+        }
+        seconds += chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+        Customer* c = dynamic_cast<Customer*>(shop->lookupUser("bench"));
+        if (shop->getStatusCount(STATUS_RETURNED) != MAX_ORDERS || !c || c->getOrdersCount() != 0)
+            consistent = false;
+        delete shop;
+    }
+
+    cout << "Transition benchmark: " << rounds << " rounds, " << applied << " transitions applied, "
+         << rejected << " rejected" << endl;
+    cout << "  Time: " << fixed << setprecision(3) << seconds << " s, throughput: "
+         << setprecision(0) << (seconds > 0 ? applied / seconds : 0.0) << " transitions/s" << endl;
+    cout << "  Counters consistent: " << (consistent ? "yes" : "NO") << endl;
+    cout << setprecision(2);
+}
+
+// Measures the checkout path (cart fill plus submitOrder) without console
+// output. Build once with and once without -DNTSHOP_METRICS=0 to get the
+// cost of the timers.
+void runCheckoutBenchmark(int rounds) {
+    double seconds = 0.0;
+    long long placed = 0;
+
+    for (int r = 0; r < rounds; ++r) {
+        NTSHOP* shop = new NTSHOP();
+        shop->registerCustomer("bench", "bench");
+        Customer* c = dynamic_cast<Customer*>(shop->findUser("bench"));
+
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        for (int i = 0; i < MAX_ORDERS; ++i) {
+            int orderId;
+            c->addToCart(shop->getProductById(1 + i % 6), 1 + i % 3);
+            c->addToCart(shop->getProductById(1 + (i + 3) % 6), 1);
+            if (c->submitOrder(i % 2 ? "Advance Payment" : "Cash on Delivery (COD)", "Normal", orderId)) placed++;
+        }
+        seconds += chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        delete shop;
+    }
+
+    cout << "Checkout benchmark (metrics " << (NTSHOP_METRICS ? "on" : "off") << "): "
+         << rounds << " rounds, " << placed << " checkouts" << endl;
+    cout << "  Time: " << fixed << setprecision(3) << seconds << " s, "
+         << setprecision(1) << (placed > 0 ? seconds * 1e9 / placed : 0.0) << " ns/checkout" << endl;
+    cout << setprecision(2);
+}
+
 void runSystem(NTSHOP* shop) {
     string username, password;
     int roleChoice;
@@ -698,9 +1817,47 @@ void runSystem(NTSHOP* shop) {
     cout << "\nThank you for using N&T SHOP. Goodbye!" << endl;
 }
 
-int main() {
+int main(int argc, char* argv[]) {
     cout << fixed << setprecision(2);
+    if (argc > 1 && string(argv[1]) == "--bench-transitions") {
+        int rounds = argc > 2 ? atoi(argv[2]) : 2000;
+        runTransitionBenchmark(rounds > 0 ? rounds : 1);
+        return 0;
+    }
+    if (argc > 1 && string(argv[1]) == "--bench-checkout") {
+        int rounds = argc > 2 ? atoi(argv[2]) : 5000;
+        runCheckoutBenchmark(rounds > 0 ? rounds : 1);
+        return 0;
+    }
     NTSHOP* shop = new NTSHOP();
+    if (argc > 1 && string(argv[1]) == "--import") {
+        // --import <kind> <file> [<kind> <file> ...]: loads the files in order,
+        // then starts the shop with the imported data.
+        if (argc < 4 || argc % 2 != 0) {
+            cout << "Usage: " << argv[0] << " --import <products|customers|orders> <file> [...]" << endl;
+            delete shop;
+            return 1;
+        }
+        bool ok = true;
+        for (int a = 2; a + 1 < argc && ok; a += 2) {
+            int kind = -1;
+            for (int k = IMPORT_PRODUCTS; k <= IMPORT_ORDERS; ++k)
+                if (equalsIgnoreCase(argv[a], IMPORT_KIND_NAMES[k])) kind = k;
+            if (kind < 0) {
+                cout << "Unknown import kind '" << argv[a] << "'." << endl;
+                ok = false;
+                break;
+            }
+            ShopImporter importer(shop, (ImportKind)kind);
+            ok = importer.importFile(argv[a + 1]);
+            if (ok) importer.report(cout);
+            else cout << "Could not open '" << argv[a + 1] << "'." << endl;
+        }
+        if (!ok) {
+            delete shop;
+            return 1;
+        }
+    }
     runSystem(shop);
     delete shop;
     return 0;